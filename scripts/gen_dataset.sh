@@ -0,0 +1,42 @@
+#!/usr/bin/env sh
+# Build a larger, representative training/benchmark CSV by tiling a real capture.
+# Each copy shifts frameNum and timestamp past the previous one, so the row mix
+# (gesturePresence = 0, empty frameNum, gesture noise, capture blocks) is kept
+# while frames stay unique.
+#
+# usage: scripts/gen_dataset.sh <repeat> <output.csv> [input.csv]
+
+set -eu
+
+REPEAT=${1:?repeat count}
+OUT=${2:?output path}
+IN=${3:-data/down-to-up.csv}
+
+mkdir -p "$(dirname "$OUT")"
+
+awk -F, -v OFS=, -v repeat="$REPEAT" '
+NR == 1 { print; next }
+{
+    rows[++n] = $0
+    if ($2 != "") {
+        if (minF == "" || $2 + 0 < minF) minF = $2 + 0
+        if (maxF == "" || $2 + 0 > maxF) maxF = $2 + 0
+    }
+    if ($1 != "") {
+        if (minT == "" || $1 + 0 < minT) minT = $1 + 0
+        if (maxT == "" || $1 + 0 > maxT) maxT = $1 + 0
+    }
+}
+END {
+    spanF = maxF - minF + 1
+    spanT = maxT - minT + 1000
+    for (r = 0; r < repeat; ++r) {
+        for (i = 1; i <= n; ++i) {
+            if (r == 0) { print rows[i]; continue }
+            $0 = rows[i]
+            if ($2 != "") $2 = sprintf("%d", $2 + r * spanF)
+            if ($1 != "") $1 = sprintf("%.4f", $1 + r * spanT)
+            print
+        }
+    }
+}' "$IN" > "$OUT"
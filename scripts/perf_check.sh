@@ -0,0 +1,54 @@
+#!/usr/bin/env sh
+# Run the pipeline benchmark and compare rows/s against a stored baseline.
+# Fails when the best of <runs> is more than <threshold>% below the baseline.
+# Baselines are machine-specific and not committed; record one with --update.
+#
+# usage: scripts/perf_check.sh <binary> <dataset.csv> <baseline.txt> <threshold%> <runs> [--update]
+
+set -eu
+
+BIN=${1:?binary}
+DATA=${2:?dataset}
+BASELINE=${3:?baseline file}
+THRESHOLD=${4:?threshold percent}
+RUNS=${5:?runs}
+MODE=${6:-}
+
+if [ "$MODE" != "--update" ] && [ ! -f "$BASELINE" ]; then
+    echo "perf-check: no baseline at $BASELINE (run 'make perf-baseline' first)" >&2
+    exit 1
+fi
+
+OUT_DIR=$(dirname "$DATA")
+best=0
+i=0
+while [ "$i" -lt "$RUNS" ]; do
+    rate=$("$BIN" "$DATA" "$OUT_DIR/out_clean.csv" "$OUT_DIR/out_dropped.csv" \
+        2>&1 >/dev/null | sed 's/\x1b\[[0-9;]*m//g' | awk '/Throughput:/ { print $3 }')
+    if [ -z "$rate" ]; then
+        echo "perf-check: no throughput reported by $BIN" >&2
+        exit 1
+    fi
+    echo "perf-check: run $((i + 1))/$RUNS: $rate rows/s"
+    best=$(awk -v a="$best" -v b="$rate" 'BEGIN { print (b > a) ? b : a }')
+    i=$((i + 1))
+done
+
+if [ "$MODE" = "--update" ]; then
+    mkdir -p "$(dirname "$BASELINE")"
+    echo "$best" > "$BASELINE"
+    echo "perf-check: baseline set to $best rows/s -> $BASELINE"
+    exit 0
+fi
+
+base=$(cat "$BASELINE")
+awk -v best="$best" -v base="$base" -v th="$THRESHOLD" 'BEGIN {
+    floor = base * (100 - th) / 100
+    change = (best - base) * 100 / base
+    printf "perf-check: best %d rows/s, baseline %d rows/s (%+.1f%%, limit -%s%%)\n", best, base, change, th
+    if (best < floor) {
+        print "perf-check: FAILED, throughput regression" > "/dev/stderr"
+        exit 1
+    }
+    print "perf-check: OK"
+}'
@@ -0,0 +1,354 @@
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "DataCleaner.hpp"
+#include "mmwave_cleaner.h"
+
+static_assert(MMWC_MAX_DEDUP_WINDOW_FRAMES == kMaxDedupWindowFrames, "dedup limit out of sync");
+static_assert(MMWC_MAX_REORDER_WINDOW_ROWS == kMaxReorderWindowRows, "reorder limit out of sync");
+
+namespace {
+
+std::string str_or_empty(const char* s) {
+    return s ? std::string(s) : std::string();
+}
+
+std::vector<std::string> to_strings(const char* const* arr, size_t n) {
+    std::vector<std::string> out;
+    if (!arr) {
+        return out;
+    }
+    out.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        out.push_back(str_or_empty(arr[i]));
+    }
+    return out;
+}
+
+std::string_view strip_cr(std::string_view s) {
+    if (!s.empty() && s.back() == '\r') {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+// Forwards session rows to the C callbacks without copying the cells
+class CallbackSink : public RowSink {
+public:
+    CallbackSink(mmwc_clean_fn onClean, mmwc_dropped_fn onDropped, void* user,
+                 const std::vector<int>& cleanPositions)
+        : onClean_(onClean), onDropped_(onDropped), user_(user), cleanPositions_(cleanPositions) {}
+
+    void onClean(const std::vector<std::string_view>& projected) override {
+        if (!onClean_) {
+            return;
+        }
+        cells_.clear();
+        for (int pos : cleanPositions_) {
+            const auto& cell = projected[static_cast<size_t>(pos)];
+            cells_.push_back(mmwc_cell{cell.data(), cell.size()});
+        }
+        onClean_(user_, cells_.data(), cells_.size());
+    }
+
+    void onDropped(const std::vector<std::string_view>& projected, const std::string& reason) override {
+        if (!onDropped_) {
+            return;
+        }
+        cells_.clear();
+        for (const auto& cell : projected) {
+            cells_.push_back(mmwc_cell{cell.data(), cell.size()});
+        }
+        onDropped_(user_, cells_.data(), cells_.size(), reason.c_str());
+    }
+
+private:
+    mmwc_clean_fn onClean_;
+    mmwc_dropped_fn onDropped_;
+    void* user_;
+    const std::vector<int>& cleanPositions_;
+    std::vector<mmwc_cell> cells_;
+};
+
+}  // namespace
+
+struct mmwc_cleaner {
+    PipelineConfig cfg;
+    bool keepAllColumns = false;
+    std::string majorityGesture;
+    bool collectStats = false;
+    mmwc_clean_fn onClean = nullptr;
+    mmwc_dropped_fn onDropped = nullptr;
+    void* user = nullptr;
+
+    std::unique_ptr<CleaningSession> session;
+    std::unique_ptr<CallbackSink> sink;
+    std::string carry;  // partial line left over from the previous chunk
+    bool finished = false;
+
+    void handleHeader(std::string_view line);
+    void handleLine(std::string_view line);
+};
+
+void mmwc_cleaner::handleHeader(std::string_view line) {
+    std::vector<std::string_view> cells;
+    split_comma_sv(strip_cr(line), cells);
+
+    std::unordered_map<std::string, int> nameToIndex;
+    std::vector<std::string> names;
+    names.reserve(cells.size());
+    for (int i = 0; i < static_cast<int>(cells.size()); ++i) {
+        names.emplace_back(cells[static_cast<size_t>(i)]);
+        nameToIndex.emplace(names.back(), i);
+    }
+    if (keepAllColumns) {
+        cfg.keepColumns = std::move(names);
+    }
+
+    session = std::make_unique<CleaningSession>(cfg, nameToIndex, majorityGesture, collectStats, nullptr);
+    sink = std::make_unique<CallbackSink>(onClean, onDropped, user, session->cleanPositions());
+}
+
+void mmwc_cleaner::handleLine(std::string_view line) {
+    if (!session) {
+        handleHeader(line);
+        return;
+    }
+    session->processLine(strip_cr(line), *sink);
+}
+
+extern "C" {
+
+void mmwc_config_init(mmwc_config* cfg) {
+    if (!cfg) {
+        return;
+    }
+    static const char* const kExcludeFromClean[] = {"gesturePresence"};
+
+    std::memset(cfg, 0, sizeof(*cfg));
+    cfg->exclude_from_clean = kExcludeFromClean;
+    cfg->exclude_from_clean_count = 1;
+    cfg->gesture_presence_col = "gesturePresence";
+    cfg->frame_num_col = "frameNum";
+    cfg->gesture_col = "gesture";
+    cfg->timestamp_col = "timestamp";
+    cfg->dedup_window_frames = PipelineConfig{}.dedupWindowFrames;
+    cfg->reorder_window_rows = 0;
+    cfg->collect_stats = 0;
+}
+
+mmwc_cleaner* mmwc_create(const mmwc_config* cfg) {
+    if (!cfg || cfg->dedup_window_frames > MMWC_MAX_DEDUP_WINDOW_FRAMES ||
+        cfg->reorder_window_rows > MMWC_MAX_REORDER_WINDOW_ROWS) {
+        return nullptr;
+    }
+
+    try {
+        auto c = std::make_unique<mmwc_cleaner>();
+        c->cfg.keepColumns = to_strings(cfg->keep_columns, cfg->keep_column_count);
+        c->keepAllColumns = (cfg->keep_columns == nullptr);
+        c->cfg.excludeFromClean = to_strings(cfg->exclude_from_clean, cfg->exclude_from_clean_count);
+        c->cfg.gesturePresenceCol = str_or_empty(cfg->gesture_presence_col);
+        c->cfg.frameNumCol = str_or_empty(cfg->frame_num_col);
+        c->cfg.gestureCol = str_or_empty(cfg->gesture_col);
+        c->cfg.timestampCol = str_or_empty(cfg->timestamp_col);
+        c->cfg.dedupWindowFrames = cfg->dedup_window_frames;
+        c->cfg.reorderWindowRows = cfg->reorder_window_rows;
+        c->majorityGesture = str_or_empty(cfg->majority_gesture);
+        c->collectStats = (cfg->collect_stats != 0);
+        c->onClean = cfg->on_clean;
+        c->onDropped = cfg->on_dropped;
+        c->user = cfg->user;
+        return c.release();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+mmwc_status mmwc_feed(mmwc_cleaner* cleaner, const char* data, size_t size) {
+    if (!cleaner || (!data && size > 0)) {
+        return MMWC_ERR_ARGUMENT;
+    }
+    if (cleaner->finished) {
+        return MMWC_ERR_STATE;
+    }
+
+    try {
+        const char* p = data;
+        const char* end = data + size;
+
+        // Complete the line split across the previous chunk boundary
+        if (!cleaner->carry.empty()) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!nl) {
+                cleaner->carry.append(p, static_cast<size_t>(end - p));
+                return MMWC_OK;
+            }
+            cleaner->carry.append(p, static_cast<size_t>(nl - p));
+            cleaner->handleLine(cleaner->carry);
+            cleaner->carry.clear();
+            p = nl + 1;
+        }
+
+        while (p < end) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!nl) {
+                break;
+            }
+            cleaner->handleLine(std::string_view(p, static_cast<size_t>(nl - p)));
+            p = nl + 1;
+        }
+
+        cleaner->carry.assign(p, static_cast<size_t>(end - p));
+        return MMWC_OK;
+    } catch (...) {
+        return MMWC_ERR_INTERNAL;
+    }
+}
+
+mmwc_status mmwc_finish(mmwc_cleaner* cleaner) {
+    if (!cleaner) {
+        return MMWC_ERR_ARGUMENT;
+    }
+    if (cleaner->finished) {
+        return MMWC_ERR_STATE;
+    }
+
+    try {
+        if (!cleaner->carry.empty()) {
+            cleaner->handleLine(cleaner->carry);
+            cleaner->carry.clear();
+        }
+        if (cleaner->session) {
+            cleaner->session->finish(*cleaner->sink);
+        }
+        cleaner->finished = true;
+        return MMWC_OK;
+    } catch (...) {
+        return MMWC_ERR_INTERNAL;
+    }
+}
+
+void mmwc_destroy(mmwc_cleaner* cleaner) {
+    delete cleaner;
+}
+
+mmwc_status mmwc_get_stats(const mmwc_cleaner* cleaner, mmwc_stats* out) {
+    if (!cleaner || !out) {
+        return MMWC_ERR_ARGUMENT;
+    }
+
+    std::memset(out, 0, sizeof(*out));
+    const CleaningSession* s = cleaner->session.get();
+    if (!s) {
+        return MMWC_OK;
+    }
+    out->rows_total = s->rowsTotal();
+    out->rows_kept = s->rowsKept();
+    out->rows_dropped = s->rowsDropped();
+    out->out_of_order_frames = s->outOfOrderCount();
+    if (const FrameDedupFilter* dedup = s->dedup()) {
+        out->duplicate_frames = dedup->duplicateCount();
+    }
+    if (const FrameReorderBuffer* reorder = s->reorder()) {
+        out->resequenced_rows = reorder->resequencedCount();
+    }
+    return MMWC_OK;
+}
+
+size_t mmwc_column_count(const mmwc_cleaner* cleaner) {
+    if (!cleaner || !cleaner->session || !cleaner->session->stats()) {
+        return 0;
+    }
+    return cleaner->session->stats()->columns().size();
+}
+
+mmwc_status mmwc_get_column_stats(const mmwc_cleaner* cleaner, size_t column, mmwc_column_stats* out) {
+    if (!out || column >= mmwc_column_count(cleaner)) {
+        return MMWC_ERR_ARGUMENT;
+    }
+
+    const StatsCollector* stats = cleaner->session->stats();
+    const ColumnStats& col = stats->columns()[column];
+    out->name = stats->names()[column].c_str();
+    out->count = col.count;
+    out->nulls = col.nulls;
+    out->non_numeric = col.nonNumeric;
+    out->min = col.min;
+    out->max = col.max;
+    out->mean = col.mean;
+    out->variance = col.variance();
+    return MMWC_OK;
+}
+
+mmwc_status mmwc_clean_buffer(const mmwc_config* cfg, const char* data, size_t size, mmwc_stats* statsOut) {
+    if (!cfg || (!data && size > 0) || cfg->dedup_window_frames > MMWC_MAX_DEDUP_WINDOW_FRAMES ||
+        cfg->reorder_window_rows > MMWC_MAX_REORDER_WINDOW_ROWS) {
+        return MMWC_ERR_ARGUMENT;
+    }
+
+    try {
+        std::string majority;
+        if (!cfg->majority_gesture) {
+            // Gesture pre-pass over the buffer, same as the executable's stage 1.5
+            const std::string gestureCol = str_or_empty(cfg->gesture_col);
+            std::unordered_map<std::string, size_t> counts;
+            std::vector<std::string_view> cells;
+            int idxGesture = -1;
+            bool header = true;
+
+            const char* p = data;
+            const char* end = data + size;
+            while (p < end) {
+                const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+                const char* lineEnd = nl ? nl : end;
+                split_comma_sv(strip_cr(std::string_view(p, static_cast<size_t>(lineEnd - p))), cells);
+
+                if (header) {
+                    for (int i = 0; i < static_cast<int>(cells.size()); ++i) {
+                        if (cells[static_cast<size_t>(i)] == gestureCol) {
+                            idxGesture = i;
+                            break;
+                        }
+                    }
+                    header = false;
+                } else {
+                    count_gesture(cells, idxGesture, counts);
+                }
+                if (!nl) {
+                    break;
+                }
+                p = nl + 1;
+            }
+            majority = majority_gesture(counts, nullptr);
+        }
+
+        mmwc_config local = *cfg;
+        if (!cfg->majority_gesture) {
+            local.majority_gesture = majority.c_str();
+        }
+
+        std::unique_ptr<mmwc_cleaner, void (*)(mmwc_cleaner*)> cleaner(mmwc_create(&local), mmwc_destroy);
+        if (!cleaner) {
+            return MMWC_ERR_INTERNAL;
+        }
+
+        mmwc_status st = mmwc_feed(cleaner.get(), data, size);
+        if (st == MMWC_OK) {
+            st = mmwc_finish(cleaner.get());
+        }
+        if (st == MMWC_OK && statsOut) {
+            st = mmwc_get_stats(cleaner.get(), statsOut);
+        }
+        return st;
+    } catch (...) {
+        return MMWC_ERR_INTERNAL;
+    }
+}
+
+}  // extern "C"
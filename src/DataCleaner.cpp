@@ -1,4 +1,7 @@
+#include <charconv>
 #include <chrono>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -30,7 +33,7 @@ void rstrip_cr(std::string& s) {
     }
 }
 
-void split_comma_sv(const std::string& line, std::vector<std::string_view>& out) {
+void split_comma_sv(std::string_view line, std::vector<std::string_view>& out) {
     out.clear();
 
     const char* s = line.data();
@@ -47,6 +50,18 @@ void split_comma_sv(const std::string& line, std::vector<std::string_view>& out)
     out.emplace_back(s + start, n - start);
 }
 
+bool parse_int64_sv(std::string_view cell, int64_t& out) {
+    const char* first = cell.data();
+    const char* last = first + cell.size();
+    const auto res = std::from_chars(first, last, out);
+    return res.ec == std::errc() && res.ptr == last;
+}
+
+static int column_index(const std::unordered_map<std::string, int>& map, const std::string& key) {
+    auto it = map.find(key);
+    return (it == map.end()) ? -1 : it->second;
+}
+
 // CsvReader implementation
 CsvReader::CsvReader(const std::string& path, size_t bufferBytes)
     : inputPath_(path), bufferBytes_(bufferBytes) {}
@@ -282,6 +297,60 @@ bool GestureMajorityFilter::shouldDrop(const std::vector<std::string_view>& rawC
     return true;
 }
 
+// Frame dedup filter implementation
+FrameDedupFilter::FrameDedupFilter(int frameIdx, int timestampIdx, size_t windowFrames)
+    : frameIdx_(frameIdx), timestampIdx_(timestampIdx) {
+    if (windowFrames > kMaxDedupWindowFrames) {
+        windowFrames = kMaxDedupWindowFrames;
+    }
+    size_t size = 1;
+    while (size < windowFrames) {
+        size <<= 1;
+    }
+    mask_ = size - 1;
+    ring_.resize(size);
+}
+
+bool FrameDedupFilter::shouldDrop(const std::vector<std::string_view>& rawCells,
+                                  std::string& reasonOut) const {
+    if (frameIdx_ < 0 || frameIdx_ >= static_cast<int>(rawCells.size())) {
+        return false;
+    }
+
+    int64_t frame;
+    if (!parse_int64_sv(rawCells[static_cast<size_t>(frameIdx_)], frame)) {
+        return false;
+    }
+
+    std::string_view ts;
+    if (timestampIdx_ >= 0 && timestampIdx_ < static_cast<int>(rawCells.size())) {
+        ts = rawCells[static_cast<size_t>(timestampIdx_)];
+    }
+
+    auto& slot = ring_[static_cast<size_t>(static_cast<uint64_t>(frame) & mask_)];
+    if (ts.size() > kDedupTimestampBytes) {
+        // Cannot be compared exactly; keep the row and forget the slot
+        slot.used = false;
+        return false;
+    }
+    if (slot.used && slot.frame == frame && std::string_view(slot.ts, slot.tsLen) == ts) {
+        ++duplicates_;
+        reasonOut = "frameNum duplicate ";
+        return true;
+    }
+
+    // Same frameNum with a different timestamp is a new capture session, not a re-send
+    slot.frame = frame;
+    std::memcpy(slot.ts, ts.data(), ts.size());
+    slot.tsLen = static_cast<uint8_t>(ts.size());
+    slot.used = true;
+    return false;
+}
+
+size_t FrameDedupFilter::duplicateCount() const {
+    return duplicates_;
+}
+
 void CompositeFilter::add(std::unique_ptr<RecordFilter> filter) {
     filters_.emplace_back(std::move(filter));
 }
@@ -295,6 +364,204 @@ bool CompositeFilter::shouldDrop(const std::vector<std::string_view>& rawCells,
     return false;
 }
 
+// FrameReorderBuffer implementation
+FrameReorderBuffer::FrameReorderBuffer(size_t capacity)
+    : capacity_(capacity < kMaxReorderWindowRows ? capacity : kMaxReorderWindowRows),
+      slots_(capacity_ + 1) {
+    freeSlots_.reserve(slots_.size());
+    for (size_t i = slots_.size(); i > 0; --i) {
+        freeSlots_.push_back(i - 1);
+    }
+}
+
+void FrameReorderBuffer::push(int64_t frame, std::string& line, const Emit& emit) {
+    const bool behindReleased = emittedAny_ && frame < lastEmitted_;
+    // A late row is out of place by at most the rows pending ahead of it
+    const bool behindWindow = seenAny_ && frame < highest_ &&
+                              static_cast<uint64_t>(highest_) - static_cast<uint64_t>(frame) > heap_.size();
+    if (behindReleased || behindWindow) {
+        // Start a new block after the pending rows
+        flush(emit);
+        emittedAny_ = false;
+        highest_ = frame;
+    } else if (seenAny_ && frame < highest_) {
+        ++resequenced_;
+    } else {
+        highest_ = frame;
+    }
+    seenAny_ = true;
+
+    const size_t slot = freeSlots_.back();
+    freeSlots_.pop_back();
+    // Swap keeps both buffers' capacity alive, so steady state does not allocate
+    slots_[slot].swap(line);
+    heap_.push(Entry{frame, seq_++, slot});
+
+    if (heap_.size() > capacity_) {
+        popOne(emit);
+    }
+}
+
+void FrameReorderBuffer::flush(const Emit& emit) {
+    while (!heap_.empty()) {
+        popOne(emit);
+    }
+}
+
+void FrameReorderBuffer::popOne(const Emit& emit) {
+    const Entry top = heap_.top();
+    heap_.pop();
+    emit(slots_[top.slot]);
+    lastEmitted_ = top.frame;
+    emittedAny_ = true;
+    freeSlots_.push_back(top.slot);
+}
+
+size_t FrameReorderBuffer::resequencedCount() const {
+    return resequenced_;
+}
+
+// Column statistics implementation
+void ColumnStats::add(double x) {
+    if (count == 0) {
+        min = x;
+        max = x;
+    } else {
+        if (x < min) {
+            min = x;
+        }
+        if (x > max) {
+            max = x;
+        }
+    }
+    ++count;
+    const double delta = x - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (x - mean);
+}
+
+// Sample variance
+double ColumnStats::variance() const {
+    return (count > 1) ? m2 / static_cast<double>(count - 1) : 0.0;
+}
+
+// Locale-independent, allocation-free parse; the whole cell must be consumed
+bool parse_double_sv(std::string_view cell, double& out) {
+    const char* first = cell.data();
+    const char* last = first + cell.size();
+    if (first != last && *first == '+') {
+        ++first;
+    }
+    const auto res = std::from_chars(first, last, out);
+    return res.ec == std::errc() && res.ptr == last;
+}
+
+// StatsCollector implementation
+StatsCollector::StatsCollector(std::vector<std::string> columnNames, int gestureIdx)
+    : names_(std::move(columnNames)), columns_(names_.size()), gestureIdx_(gestureIdx) {}
+
+void StatsCollector::observe(const std::vector<std::string_view>& rawCells,
+                             const std::vector<std::string_view>& projected) {
+    ++rows_;
+    count_gesture(rawCells, gestureIdx_, gestures_);
+    const size_t n = (projected.size() < columns_.size()) ? projected.size() : columns_.size();
+    for (size_t i = 0; i < n; ++i) {
+        const auto cell = projected[i];
+        auto& col = columns_[i];
+        if (cell.empty()) {
+            ++col.nulls;
+            continue;
+        }
+        double x;
+        if (parse_double_sv(cell, x)) {
+            col.add(x);
+        } else {
+            ++col.nonNumeric;
+        }
+    }
+}
+
+size_t StatsCollector::rows() const {
+    return rows_;
+}
+
+const std::vector<std::string>& StatsCollector::names() const {
+    return names_;
+}
+
+const std::vector<ColumnStats>& StatsCollector::columns() const {
+    return columns_;
+}
+
+static void write_json_string(std::ostream& out, const std::string& s) {
+    out << '"';
+    static const char kHex[] = "0123456789abcdef";
+    for (char c : s) {
+        const auto u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (u < 0x20) {
+            out << "\\u00" << kHex[u >> 4] << kHex[u & 0xf];
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+static void write_json_number(std::ostream& out, double x) {
+    if (std::isfinite(x)) {
+        out << x;
+    } else {
+        out << "null";
+    }
+}
+
+bool StatsCollector::writeJson(const std::string& path, size_t rowsKept, size_t rowsDropped) const {
+    std::ofstream out(path, std::ios::out | std::ios::binary);
+    if (!out) {
+        return false;
+    }
+    out << std::setprecision(17);
+
+    out << "{\n  \"rowsProfiled\": " << rows_
+        << ",\n  \"rowsKept\": " << rowsKept
+        << ",\n  \"rowsDropped\": " << rowsDropped
+        << ",\n  \"columns\": [";
+
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        const auto& col = columns_[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": ";
+        write_json_string(out, names_[i]);
+        out << ", \"count\": " << col.count
+            << ", \"nulls\": " << col.nulls
+            << ", \"nonNumeric\": " << col.nonNumeric;
+        if (col.count > 0) {
+            out << ", \"min\": ";
+            write_json_number(out, col.min);
+            out << ", \"max\": ";
+            write_json_number(out, col.max);
+            out << ", \"mean\": ";
+            write_json_number(out, col.mean);
+            out << ", \"variance\": ";
+            write_json_number(out, col.variance());
+        }
+        out << "}";
+    }
+
+    out << "\n  ],\n  \"gestures\": {";
+    bool first = true;
+    for (const auto& kv : gestures_) {
+        out << (first ? "\n    " : ",\n    ");
+        write_json_string(out, kv.first);
+        out << ": " << kv.second;
+        first = false;
+    }
+    out << "\n  }\n}\n";
+
+    return static_cast<bool>(out);
+}
+
 // Benchmarking implementation
 void Bench::addSplit(ns d) {
     durSplit_ += d;
@@ -316,6 +583,10 @@ void Bench::addWriteDrop(ns d) {
     durWriteDrop_ += d;
 }
 
+void Bench::addStats(ns d) {
+    durStats_ += d;
+}
+
 void Bench::setTotal(ns d) {
     durTotal_ = d;
 }
@@ -334,10 +605,249 @@ void Bench::printSummary(size_t total, size_t kept, size_t dropped) const {
               << " Column filtering: " << std::setw(10) << msAfterColumn << " ms\n";
     std::cerr << COLOR_BENCH "[BENCH]" COLOR_RESET
               << " Record filtering: " << std::setw(10) << msAfterRecord << " ms\n";
+    if (durStats_.count() > 0) {
+        std::cerr << COLOR_BENCH "[BENCH]" COLOR_RESET
+                  << " Profiling:        " << std::setw(10) << to_ms(durStats_) << " ms\n";
+    }
     std::cerr << COLOR_BENCH "[BENCH]" COLOR_RESET
               << " Total time:       " << std::setw(10) << msTotal << " ms\n";
+    if (msTotal > 0.0) {
+        const long long rowsPerSec = std::llround(static_cast<double>(total) * 1000.0 / msTotal);
+        std::cerr << COLOR_BENCH "[BENCH]" COLOR_RESET
+                  << " Throughput:       " << std::setw(10) << rowsPerSec << " rows/s\n";
+    }
 }
 
+// Majority gesture helpers
+void count_gesture(const std::vector<std::string_view>& rawCells, int gestureIdx,
+                   std::unordered_map<std::string, size_t>& countsOut) {
+    if (gestureIdx < 0 || gestureIdx >= static_cast<int>(rawCells.size())) {
+        return;
+    }
+    std::string_view g = rawCells[static_cast<size_t>(gestureIdx)];
+    if (g != "0" && !g.empty()) {
+        countsOut[std::string(g)]++;
+    }
+}
+
+std::string majority_gesture(const std::unordered_map<std::string, size_t>& counts, size_t* countOut) {
+    std::string majority;
+    size_t maxCount = 0;
+    for (const auto& kv : counts) {
+        if (kv.second > maxCount) {
+            majority = kv.first;
+            maxCount = kv.second;
+        }
+    }
+    if (countOut) {
+        *countOut = maxCount;
+    }
+    return majority;
+}
+
+// CleaningSession implementation
+CleaningSession::CleaningSession(const PipelineConfig& cfg,
+                                 const std::unordered_map<std::string, int>& nameToIndex,
+                                 const std::string& majorityGesture,
+                                 bool collectStats,
+                                 Bench* bench)
+    : projector_(cfg.keepColumns, nameToIndex),
+      cleanPositions_(projector_.positionsExcluding(cfg.excludeFromClean)),
+      bench_(bench),
+      idxFrameNum_(column_index(nameToIndex, cfg.frameNumCol)) {
+    const int idxGesturePresence = column_index(nameToIndex, cfg.gesturePresenceCol);
+    const int idxGesture = column_index(nameToIndex, cfg.gestureCol);
+    const int idxTimestamp = column_index(nameToIndex, cfg.timestampCol);
+
+    filter_.add(std::make_unique<GesturePresenceZeroFilter>(idxGesturePresence));
+    filter_.add(std::make_unique<FrameNumEmptyFilter>(idxFrameNum_));
+    filter_.add(std::make_unique<GestureMajorityFilter>(idxGesture, majorityGesture));
+
+    // Stateful, so it runs last: only rows that passed every other filter enter its index
+    if (cfg.dedupWindowFrames > 0) {
+        auto f = std::make_unique<FrameDedupFilter>(idxFrameNum_, idxTimestamp, cfg.dedupWindowFrames);
+        dedup_ = f.get();
+        filter_.add(std::move(f));
+    }
+
+    // Profiling sees clean rows only, see processRow
+    if (collectStats) {
+        stats_ = std::make_unique<StatsCollector>(projector_.keepNames(), idxGesture);
+    }
+
+    if (cfg.reorderWindowRows > 0 && idxFrameNum_ >= 0) {
+        reorder_ = std::make_unique<FrameReorderBuffer>(cfg.reorderWindowRows);
+    }
+
+    rawCells_.reserve(nameToIndex.size() + 8);
+    projected_.reserve(projector_.keepNames().size());
+}
+
+void CleaningSession::processLine(std::string_view line, RowSink& sink) {
+    processRow(line, nullptr, sink);
+}
+
+void CleaningSession::processLine(std::string& line, RowSink& sink) {
+    processRow(line, &line, sink);
+}
+
+void CleaningSession::processRow(std::string_view line, std::string* owned, RowSink& sink) {
+    ++rowsTotal_;
+
+    const auto t0 = bench_ ? Clock::now() : Clock::time_point{};
+    split_comma_sv(line, rawCells_);
+    const auto t1 = bench_ ? Clock::now() : t0;
+
+    // Project
+    projector_.project(rawCells_, projected_);
+    const auto t2 = bench_ ? Clock::now() : t1;
+
+    // Filter
+    reason_.clear();
+    const bool drop = filter_.shouldDrop(rawCells_, reason_);
+    auto t3 = bench_ ? Clock::now() : t2;
+
+    if (bench_) {
+        bench_->addSplit(t1 - t0);
+        bench_->addProject(t2 - t1);
+        bench_->addFilter(t3 - t2);
+    }
+
+    if (drop) {
+        sink.onDropped(projected_, reason_);
+        if (bench_) {
+            bench_->addWriteDrop(Clock::now() - t3);
+        }
+        ++rowsDropped_;
+        return;
+    }
+
+    // Profile clean rows only, so the statistics describe what training sees
+    if (stats_) {
+        stats_->observe(rawCells_, projected_);
+        if (bench_) {
+            const auto tStats = Clock::now();
+            bench_->addStats(tStats - t3);
+            t3 = tStats;
+        }
+    }
+
+    int64_t frame = 0;
+    const bool hasFrame = idxFrameNum_ >= 0 && idxFrameNum_ < static_cast<int>(rawCells_.size()) &&
+                          parse_int64_sv(rawCells_[static_cast<size_t>(idxFrameNum_)], frame);
+    if (hasFrame) {
+        if (seenFrame_ && frame < lastFrame_) {
+            ++outOfOrder_;
+        }
+        lastFrame_ = frame;
+        seenFrame_ = true;
+    }
+
+    if (reorder_ && !hasFrame) {
+        // No integer frameNum to sort by (e.g. "12.0"): keep its position after the pending rows
+        reorder_->flush([this, &sink](const std::string& l) { emitReordered(l, sink); });
+        sink.onClean(projected_);
+    } else if (reorder_) {
+        // The buffer needs its own copy unless the caller lent us a std::string;
+        // rawCells_/projected_ are not used past here
+        std::string* held = owned;
+        if (!held) {
+            ownedLine_.assign(line.data(), line.size());
+            held = &ownedLine_;
+        }
+        reorder_->push(frame, *held, [this, &sink](const std::string& l) { emitReordered(l, sink); });
+    } else {
+        sink.onClean(projected_);
+    }
+
+    if (bench_) {
+        bench_->addWriteClean(Clock::now() - t3);
+    }
+    ++rowsKept_;
+}
+
+void CleaningSession::finish(RowSink& sink) {
+    if (reorder_) {
+        reorder_->flush([this, &sink](const std::string& l) { emitReordered(l, sink); });
+    }
+}
+
+void CleaningSession::emitReordered(const std::string& line, RowSink& sink) {
+    split_comma_sv(line, emitCells_);
+    projector_.project(emitCells_, emitProjected_);
+    sink.onClean(emitProjected_);
+}
+
+const ColumnProjector& CleaningSession::projector() const {
+    return projector_;
+}
+
+const std::vector<int>& CleaningSession::cleanPositions() const {
+    return cleanPositions_;
+}
+
+const StatsCollector* CleaningSession::stats() const {
+    return stats_.get();
+}
+
+const FrameDedupFilter* CleaningSession::dedup() const {
+    return dedup_;
+}
+
+const FrameReorderBuffer* CleaningSession::reorder() const {
+    return reorder_.get();
+}
+
+size_t CleaningSession::outOfOrderCount() const {
+    return outOfOrder_;
+}
+
+size_t CleaningSession::rowsTotal() const {
+    return rowsTotal_;
+}
+
+size_t CleaningSession::rowsKept() const {
+    return rowsKept_;
+}
+
+size_t CleaningSession::rowsDropped() const {
+    return rowsDropped_;
+}
+
+// Writes session output to the clean/dropped CSV files
+class CsvRowSink : public RowSink {
+public:
+    CsvRowSink(CsvWriter& clean, CsvWriter& dropped, const std::vector<int>& cleanPositions,
+               bool printDropped)
+        : clean_(clean), dropped_(dropped), cleanPositions_(cleanPositions),
+          printDropped_(printDropped) {}
+
+    void onClean(const std::vector<std::string_view>& projected) override {
+        clean_.writeRowSubset(projected, cleanPositions_);
+    }
+
+    void onDropped(const std::vector<std::string_view>& projected, const std::string& reason) override {
+        dropped_.writeRowFull(projected);
+
+        if (printDropped_) {
+            std::cerr << COLOR_DROP "[DROP] " COLOR_RESET "reason: " << reason << std::setw(8) << " row = ";
+            for (size_t i = 0; i < projected.size(); ++i) {
+                if (i) {
+                    std::cerr << ", ";
+                }
+                std::cerr.write(projected[i].data(), static_cast<std::streamsize>(projected[i].size()));
+            }
+            std::cerr << "\n";
+        }
+    }
+
+private:
+    CsvWriter& clean_;
+    CsvWriter& dropped_;
+    const std::vector<int>& cleanPositions_;
+    bool printDropped_;
+};
+
 // DataCleaningPipeline implementation
 DataCleaningPipeline::DataCleaningPipeline(PipelineConfig cfg) : cfg_(std::move(cfg)) {}
 
@@ -366,24 +876,10 @@ int DataCleaningPipeline::run() {
     }
     std::cerr << COLOR_STAGE "\n[STAGE 0] " COLOR_RESET "Input columns = " << headerNames.size() << "\n";
 
-    // Projection
-    ColumnProjector projector(cfg_.keepColumns, nameToIndex);
-    std::cerr << COLOR_STAGE "\n[STAGE 1] " COLOR_RESET "Column pruning: removing columns and projecting... "
-              << "(kept = " << projector.keepNames().size()
-              << ", removed = " << projector.removedColumnsApprox(headerNames.size())
-              << ", missing in input = " << projector.missingKeptCount() << ")\n";
-
-    // Output subset for CLEAN file
-    const auto cleanPositions = projector.positionsExcluding(cfg_.excludeFromClean);
+    // Majority gesture
+    const int idxGesture = column_index(nameToIndex, cfg_.gestureCol);
+    std::unordered_map<std::string, size_t> gestureCount;
 
-    // Filter setup
-    const int idxGesturePresence = indexOf(nameToIndex, cfg_.gesturePresenceCol);
-    const int idxFrameNum = indexOf(nameToIndex, cfg_.frameNumCol);
-    const int idxGesture = indexOf(nameToIndex, cfg_.gestureCol);
-
-    // Calculate majority gesture
-    std::string majorityGesture;
-    
     {
         CsvReader statReader(cfg_.inputPath, cfg_.readerBufferBytes);
 
@@ -394,43 +890,36 @@ int DataCleaningPipeline::run() {
 
         std::string line;
         statReader.readHeader(headerNames, nameToIndex);
-        std::unordered_map<std::string, size_t> gestureCount;
-        
+        std::vector<std::string_view> cells;
+
         while (statReader.readLine(line)) {
-            std::vector<std::string_view> cells;
             split_comma_sv(line, cells);
-            if (idxGesture >= 0 && idxGesture < static_cast<int>(cells.size())) {
-                std::string_view g = cells[idxGesture];
-                if (g != "0" && !g.empty()) {
-                    gestureCount[std::string(g)]++;
-                }
-            }
+            count_gesture(cells, idxGesture, gestureCount);
         }
 
         statReader.close();
-        size_t maxCount = 0;
-        majorityGesture = "";
-        
-        for (const auto& kv : gestureCount) {
-            if (kv.second > maxCount) {
-                majorityGesture = kv.first;
-                maxCount = kv.second;
-            }
-        }
+    }
 
-        if (majorityGesture == "") {
-            std::cerr << COLOR_STAGE "\n[STAGE 1.5] " COLOR_RESET 
-                      << "WARNING: No valid non-zero gesture found.\n";
-        } else {
-            std::cerr << COLOR_STAGE "\n[STAGE 1.5] " COLOR_RESET
-                      << "Majority gesture = [" << majorityGesture << "], which appeared " << maxCount << " times\n";
-        }
+    size_t majorityCount = 0;
+    const std::string majorityGesture = majority_gesture(gestureCount, &majorityCount);
+
+    // Projection + filters
+    const bool profile = cfg_.collectProfile && !cfg_.outputProfilePath.empty();
+    CleaningSession session(cfg_, nameToIndex, majorityGesture, profile, &bench_);
+    const ColumnProjector& projector = session.projector();
+    std::cerr << COLOR_STAGE "\n[STAGE 1] " COLOR_RESET "Column pruning: removing columns and projecting... "
+              << "(kept = " << projector.keepNames().size()
+              << ", removed = " << projector.removedColumnsApprox(headerNames.size())
+              << ", missing in input = " << projector.missingKeptCount() << ")\n";
+
+    if (majorityGesture == "") {
+        std::cerr << COLOR_STAGE "\n[STAGE 1.5] " COLOR_RESET 
+                  << "WARNING: No valid non-zero gesture found.\n";
+    } else {
+        std::cerr << COLOR_STAGE "\n[STAGE 1.5] " COLOR_RESET
+                  << "Majority gesture = [" << majorityGesture << "], which appeared " << majorityCount << " times\n";
     }
 
-    CompositeFilter filter;
-    filter.add(std::make_unique<GesturePresenceZeroFilter>(idxGesturePresence));
-    filter.add(std::make_unique<FrameNumEmptyFilter>(idxFrameNum));
-    filter.add(std::make_unique<GestureMajorityFilter>(idxGesture, majorityGesture));
     std::cerr << COLOR_STAGE "\n[STAGE 2] " COLOR_RESET "Record filtering: cleaning data...\n\n";
 
     // Writers
@@ -446,65 +935,22 @@ int DataCleaningPipeline::run() {
     }
 
     // Headers
-    cleanWriter.writeHeaderSubset(projector.keepNames(), cleanPositions);
+    cleanWriter.writeHeaderSubset(projector.keepNames(), session.cleanPositions());
     droppedWriter.writeHeader(projector.keepNames());
 
     // Process rows
-    size_t rowsTotal = 0, rowsKept = 0, rowsDropped = 0;
+    CsvRowSink sink(cleanWriter, droppedWriter, session.cleanPositions(), cfg_.printDroppedToStderr);
     std::string line;
-    std::vector<std::string_view> rawCells;
-    rawCells.reserve(headerNames.size() + 8);
-
-    std::vector<std::string_view> projected;
-    projected.reserve(projector.keepNames().size());
 
     for (;;) {
         if (!reader.readLine(line)) {
             break;
         }
-
-        ++rowsTotal;
-
-        const auto t0 = Clock::now();
-        split_comma_sv(line, rawCells);
-        const auto t1 = Clock::now();
-        bench_.addSplit(t1 - t0);
-
-        // Project
-        projector.project(rawCells, projected);
-        const auto t2 = Clock::now();
-        bench_.addProject(t2 - t1);
-
-        // Filter
-        std::string reason;
-        const bool drop = filter.shouldDrop(rawCells, reason);
-        const auto t3 = Clock::now();
-        bench_.addFilter(t3 - t2);
-
-        if (drop) {
-            droppedWriter.writeRowFull(projected);
-            const auto t4 = Clock::now();
-            bench_.addWriteDrop(t4 - t3);
-            ++rowsDropped;
-
-            if (cfg_.printDroppedToStderr) {
-                std::cerr << COLOR_DROP "[DROP] " COLOR_RESET "reason: " << reason << std::setw(8) << " row = ";
-                for (size_t i = 0; i < projected.size(); ++i) {
-                    if (i) {
-                        std::cerr << ", ";
-                    }
-                    std::cerr.write(projected[i].data(), static_cast<std::streamsize>(projected[i].size()));
-                }
-                std::cerr << "\n";
-            }
-        } else {
-            cleanWriter.writeRowSubset(projected, cleanPositions);
-            const auto t4 = Clock::now();
-            bench_.addWriteClean(t4 - t3);
-            ++rowsKept;
-        }
+        session.processLine(line, sink);
     }
 
+    session.finish(sink);
+
     reader.close();
     cleanWriter.close();
     droppedWriter.close();
@@ -512,15 +958,32 @@ int DataCleaningPipeline::run() {
     const auto tEnd = Clock::now();
     bench_.setTotal(tEnd - tStart);
 
+    const size_t rowsTotal = session.rowsTotal();
+    const size_t rowsKept = session.rowsKept();
+    const size_t rowsDropped = session.rowsDropped();
+
     std::cerr << COLOR_STAGE "\n[STAGE 3] " COLOR_RESET "Materialization: wrote outputs\n";
     std::cerr << "    - Cleaned rows: " << std::setw(6) << rowsKept << "   -->   " << cfg_.outputCleanPath << "\n";
     std::cerr << "    - Dropped rows: " << std::setw(6) << rowsDropped << "   -->   " << cfg_.outputDroppedPath << "\n";
 
+    std::cerr << "    - Out-of-order frames: " << session.outOfOrderCount();
+    if (const FrameReorderBuffer* reorder = session.reorder()) {
+        std::cerr << " (re-sequenced: " << reorder->resequencedCount() << ")";
+    }
+    if (const FrameDedupFilter* dedup = session.dedup()) {
+        std::cerr << ", duplicate frames dropped: " << dedup->duplicateCount();
+    }
+    std::cerr << "\n";
+
+    if (const StatsCollector* stats = session.stats()) {
+        if (stats->writeJson(cfg_.outputProfilePath, rowsKept, rowsDropped)) {
+            std::cerr << "    - Profile:      " << std::setw(6) << stats->rows() << "   -->   " << cfg_.outputProfilePath << "\n";
+        } else {
+            std::cerr << "ERROR: cannot write profile: " << cfg_.outputProfilePath << "\n";
+            return 1;
+        }
+    }
+
     bench_.printSummary(rowsTotal, rowsKept, rowsDropped);
     return 0;
 }
-
-int DataCleaningPipeline::indexOf(const std::unordered_map<std::string, int>& map, const std::string& key) {
-    auto it = map.find(key);
-    return (it == map.end()) ? -1 : it->second;
-}
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <queue>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -14,7 +17,8 @@ using ns = std::chrono::nanoseconds;
 
 // CSV helper
 void rstrip_cr(std::string& s);
-void split_comma_sv(const std::string& line, std::vector<std::string_view>& out);
+void split_comma_sv(std::string_view line, std::vector<std::string_view>& out);
+bool parse_int64_sv(std::string_view cell, int64_t& out);
 
 // Pipeline config
 struct PipelineConfig {
@@ -26,11 +30,22 @@ struct PipelineConfig {
     std::string gesturePresenceCol;
     std::string frameNumCol;
     std::string gestureCol;
+    std::string timestampCol;
 
     std::vector<std::string> excludeFromClean;
 
     bool printDroppedToStderr = false;
     size_t readerBufferBytes = (1u << 16);  // 64 KB
+
+    // Duplicate frames: size of the frameNum index (0 disables dedup)
+    size_t dedupWindowFrames = 4096;
+    // Re-sequence clean rows by frameNum within this many rows (0 disables)
+    size_t reorderWindowRows = 0;
+
+    // Dataset profile (per-column statistics of clean rows). Opt-in: parsing every
+    // kept cell costs roughly 15-20% of total run time.
+    bool collectProfile = false;
+    std::string outputProfilePath;
 };
 
 class CsvReader {
@@ -120,6 +135,42 @@ private:
     std::string majorityGesture_;
 };
 
+// Upper bounds for the frame windows; larger values are clamped.
+// 2^20 dedup slots take 48 MB, 2^16 reorder slots hold at most 64K lines.
+constexpr size_t kMaxDedupWindowFrames = size_t(1) << 20;
+constexpr size_t kMaxReorderWindowRows = size_t(1) << 16;
+
+// Timestamp bytes kept per dedup slot; rows with longer timestamps are never
+// treated as duplicates
+constexpr size_t kDedupTimestampBytes = 32;
+
+// Drops rows whose (frameNum, timestamp) was already seen within the last
+// windowFrames frame numbers. Fixed-size ring indexed by frameNum, O(1) per row;
+// the timestamp cell is compared byte for byte.
+class FrameDedupFilter : public RecordFilter {
+public:
+    FrameDedupFilter(int frameIdx, int timestampIdx, size_t windowFrames);
+    bool shouldDrop(const std::vector<std::string_view>& rawCells,
+                    std::string& reasonOut) const override;
+    size_t duplicateCount() const;
+
+private:
+    struct Slot {
+        int64_t frame = 0;
+        char ts[kDedupTimestampBytes];
+        uint8_t tsLen = 0;
+        bool used = false;
+    };
+
+    int frameIdx_;
+    int timestampIdx_;
+    size_t mask_;
+
+    // Filtering is logically const for the other filters; this one keeps history
+    mutable std::vector<Slot> ring_;
+    mutable size_t duplicates_ = 0;
+};
+
 class CompositeFilter {
 public:
     void add(std::unique_ptr<RecordFilter> filter);
@@ -129,6 +180,79 @@ private:
     std::vector<std::unique_ptr<RecordFilter>> filters_;
 };
 
+// Online statistics for one column (Welford)
+struct ColumnStats {
+    size_t count = 0;       // numeric cells
+    size_t nulls = 0;       // empty cells
+    size_t nonNumeric = 0;  // non-empty cells that failed to parse
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void add(double x);
+    double variance() const;
+};
+
+bool parse_double_sv(std::string_view cell, double& out);
+
+class StatsCollector {
+public:
+    // gestureIdx is the raw (pre-projection) index of the gesture column, -1 if absent
+    StatsCollector(std::vector<std::string> columnNames, int gestureIdx);
+    void observe(const std::vector<std::string_view>& rawCells, const std::vector<std::string_view>& projected);
+    bool writeJson(const std::string& path, size_t rowsKept, size_t rowsDropped) const;
+    size_t rows() const;
+    const std::vector<std::string>& names() const;
+    const std::vector<ColumnStats>& columns() const;
+
+private:
+    std::vector<std::string> names_;
+    std::vector<ColumnStats> columns_;
+    std::unordered_map<std::string, size_t> gestures_;
+    int gestureIdx_;
+    size_t rows_ = 0;
+};
+
+// Holds up to `capacity` rows and releases them in frameNum order.
+// A row behind a frame that was already released cannot be placed any more,
+// and a row further behind the highest pending frame than there are pending
+// rows cannot be a late arrival; both start a new block (e.g. a new capture
+// session) and the pending rows are flushed before it, so blocks are never
+// interleaved.
+class FrameReorderBuffer {
+public:
+    using Emit = std::function<void(const std::string& line)>;
+
+    explicit FrameReorderBuffer(size_t capacity);
+    void push(int64_t frame, std::string& line, const Emit& emit);
+    void flush(const Emit& emit);
+    size_t resequencedCount() const;
+
+private:
+    struct Entry {
+        int64_t frame;
+        uint64_t seq;
+        size_t slot;
+        bool operator>(const Entry& o) const {
+            return (frame != o.frame) ? frame > o.frame : seq > o.seq;
+        }
+    };
+
+    void popOne(const Emit& emit);
+
+    size_t capacity_;
+    std::vector<std::string> slots_;
+    std::vector<size_t> freeSlots_;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap_;
+    uint64_t seq_ = 0;
+    int64_t highest_ = 0;
+    int64_t lastEmitted_ = 0;
+    bool seenAny_ = false;
+    bool emittedAny_ = false;
+    size_t resequenced_ = 0;
+};
+
 class Bench {
 public:
     void addSplit(ns d);
@@ -136,6 +260,7 @@ public:
     void addFilter(ns d);
     void addWriteClean(ns d);
     void addWriteDrop(ns d);
+    void addStats(ns d);
     void setTotal(ns d);
     void printSummary(size_t total, size_t kept, size_t dropped) const;
 
@@ -145,17 +270,82 @@ private:
     ns durFilter_{0};
     ns durWriteClean_{0};
     ns durWriteDrop_{0};
+    ns durStats_{0};
     ns durTotal_{0};
 };
 
+// Majority gesture helpers (the majority is computed over non-zero, non-empty values)
+void count_gesture(const std::vector<std::string_view>& rawCells, int gestureIdx,
+                   std::unordered_map<std::string, size_t>& countsOut);
+std::string majority_gesture(const std::unordered_map<std::string, size_t>& counts, size_t* countOut);
+
+// Receives rows from a CleaningSession; the views are only valid during the call
+class RowSink {
+public:
+    virtual ~RowSink() = default;
+    virtual void onClean(const std::vector<std::string_view>& projected) = 0;
+    virtual void onDropped(const std::vector<std::string_view>& projected, const std::string& reason) = 0;
+};
+
+// Per-row cleaning core (split, project, filter, profile, reorder) without any I/O.
+// Shared by DataCleaningPipeline and the C API; bench may be null.
+class CleaningSession {
+public:
+    CleaningSession(const PipelineConfig& cfg,
+                    const std::unordered_map<std::string, int>& nameToIndex,
+                    const std::string& majorityGesture,
+                    bool collectStats,
+                    Bench* bench);
+    void processLine(std::string_view line, RowSink& sink);
+    // Same as above, but may swap the buffer out of `line` when reordering
+    void processLine(std::string& line, RowSink& sink);
+    void finish(RowSink& sink);
+
+    const ColumnProjector& projector() const;
+    const std::vector<int>& cleanPositions() const;
+    const StatsCollector* stats() const;
+    const FrameDedupFilter* dedup() const;
+    const FrameReorderBuffer* reorder() const;
+    // Kept rows whose frameNum is lower than the previous kept row's
+    size_t outOfOrderCount() const;
+    size_t rowsTotal() const;
+    size_t rowsKept() const;
+    size_t rowsDropped() const;
+
+private:
+    void processRow(std::string_view line, std::string* owned, RowSink& sink);
+    void emitReordered(const std::string& line, RowSink& sink);
+
+    ColumnProjector projector_;
+    std::vector<int> cleanPositions_;
+    CompositeFilter filter_;
+    const FrameDedupFilter* dedup_ = nullptr;
+    std::unique_ptr<StatsCollector> stats_;
+    std::unique_ptr<FrameReorderBuffer> reorder_;
+    Bench* bench_;
+    int idxFrameNum_;
+
+    std::vector<std::string_view> rawCells_;
+    std::vector<std::string_view> projected_;
+    std::vector<std::string_view> emitCells_;
+    std::vector<std::string_view> emitProjected_;
+    std::string reason_;
+    std::string ownedLine_;
+    int64_t lastFrame_ = 0;
+    bool seenFrame_ = false;
+    size_t outOfOrder_ = 0;
+
+    size_t rowsTotal_ = 0;
+    size_t rowsKept_ = 0;
+    size_t rowsDropped_ = 0;
+};
+
 class DataCleaningPipeline {
 public:
     explicit DataCleaningPipeline(PipelineConfig cfg);
     int run();
 
 private:
-    static int indexOf(const std::unordered_map<std::string, int>& map, const std::string& key);
-
     static std::string computeMajorityGesture(
         CsvReader& reader,
         int gestureIdx);
@@ -17,6 +17,10 @@ int main(int argc, char* argv[]) {
     cfg.outputCleanPath = getArg(argc, argv, 2, defaultCleanPath);
     cfg.outputDroppedPath = getArg(argc, argv, 3, defaultDroppedPath);
 
+    // Dataset profile is opt-in (~15-20% of run time): written only when a path is given
+    cfg.outputProfilePath = getArg(argc, argv, 4, "");
+    cfg.collectProfile = !cfg.outputProfilePath.empty();
+
     // Columns to keep
     cfg.keepColumns = {
         "timestamp", "frameNum", "error", "gesturePresence", "gesture",
@@ -29,14 +33,19 @@ int main(int argc, char* argv[]) {
     cfg.gesturePresenceCol = "gesturePresence";
     cfg.frameNumCol = "frameNum";
     cfg.gestureCol = "gesture";
+    cfg.timestampCol = "timestamp";
     cfg.excludeFromClean = {"gesturePresence"};
+
+    // Duplicate / out-of-order frames (reorderWindowRows = 0 keeps input order)
+    cfg.dedupWindowFrames = 4096;
+    cfg.reorderWindowRows = 0;
     
     // For debugging: print dropped rows to console
     cfg.printDroppedToStderr = true;
 
     if (argc == 1) {
         std::cout << "\nUsing default file paths.\n";
-        std::cout << "\nTo customize: " << argv[0] << " [input.csv] [output_clean.csv] [output_dropped.csv]\n";
+        std::cout << "\nTo customize: " << argv[0] << " [input.csv] [output_clean.csv] [output_dropped.csv] [profile.json]\n";
     }
 
     DataCleaningPipeline pipeline(cfg);
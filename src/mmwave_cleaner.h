@@ -0,0 +1,111 @@
+#ifndef MMWAVE_CLEANER_H
+#define MMWAVE_CLEANER_H
+
+// C API for embedding the cleaner in-process (libmmwave_cleaner.a / .so).
+//
+// Push-based: feed the CSV bytes in chunks of any size, the first line is the
+// header. Rows are returned through callbacks as cells valid only during the
+// callback. Dropped rows, and clean rows when reorder_window_rows is 0, point
+// into the caller's chunk; only a line split across two chunks is copied.
+// With reordering on, every clean row is copied into an internal buffer and
+// on_clean cells point there. Nothing is written to the console or to files.
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mmwc_cleaner mmwc_cleaner;
+
+// Window limits; mmwc_create rejects larger values
+#define MMWC_MAX_DEDUP_WINDOW_FRAMES ((size_t)1 << 20)
+#define MMWC_MAX_REORDER_WINDOW_ROWS ((size_t)1 << 16)
+
+typedef enum mmwc_status {
+    MMWC_OK = 0,
+    MMWC_ERR_ARGUMENT = 1,   // null handle/config/output or out-of-range index
+    MMWC_ERR_STATE = 2,      // feed after finish
+    MMWC_ERR_INTERNAL = 3    // allocation failure or other internal error
+} mmwc_status;
+
+typedef struct mmwc_cell {
+    const char* data;
+    size_t size;
+} mmwc_cell;
+
+// Clean rows carry the kept columns minus exclude_from_clean
+typedef void (*mmwc_clean_fn)(void* user, const mmwc_cell* cells, size_t count);
+// Dropped rows carry all kept columns; reason is NUL-terminated
+typedef void (*mmwc_dropped_fn)(void* user, const mmwc_cell* cells, size_t count, const char* reason);
+
+typedef struct mmwc_config {
+    // Columns to keep, in output order; NULL keeps every header column
+    const char* const* keep_columns;
+    size_t keep_column_count;
+    const char* const* exclude_from_clean;
+    size_t exclude_from_clean_count;
+
+    const char* gesture_presence_col;
+    const char* frame_num_col;
+    const char* gesture_col;
+    const char* timestamp_col;
+
+    // Rows with another non-zero gesture are dropped; NULL/"" disables the check
+    // (mmwc_clean_buffer computes it from the data when NULL)
+    const char* majority_gesture;
+
+    size_t dedup_window_frames;  // 0 disables dedup, at most MMWC_MAX_DEDUP_WINDOW_FRAMES
+    size_t reorder_window_rows;  // 0 keeps input order, at most MMWC_MAX_REORDER_WINDOW_ROWS
+    int collect_stats;           // per-column statistics of clean rows, see mmwc_get_column_stats
+
+    mmwc_clean_fn on_clean;      // may be NULL
+    mmwc_dropped_fn on_dropped;  // may be NULL
+    void* user;
+} mmwc_config;
+
+typedef struct mmwc_stats {
+    size_t rows_total;
+    size_t rows_kept;
+    size_t rows_dropped;
+    size_t duplicate_frames;
+    size_t out_of_order_frames;
+    size_t resequenced_rows;
+} mmwc_stats;
+
+typedef struct mmwc_column_stats {
+    const char* name;  // owned by the cleaner
+    size_t count;
+    size_t nulls;
+    size_t non_numeric;
+    double min;
+    double max;
+    double mean;
+    double variance;
+} mmwc_column_stats;
+
+// Same filter columns and windows as the data_cleaner executable; keeps every
+// column and has no callbacks set
+void mmwc_config_init(mmwc_config* cfg);
+
+// Returns NULL on invalid config (including windows above the limits) or
+// allocation failure. Strings in cfg are copied.
+mmwc_cleaner* mmwc_create(const mmwc_config* cfg);
+mmwc_status mmwc_feed(mmwc_cleaner* cleaner, const char* data, size_t size);
+// Processes a trailing line without '\n' and releases reordered rows
+mmwc_status mmwc_finish(mmwc_cleaner* cleaner);
+void mmwc_destroy(mmwc_cleaner* cleaner);
+
+mmwc_status mmwc_get_stats(const mmwc_cleaner* cleaner, mmwc_stats* out);
+size_t mmwc_column_count(const mmwc_cleaner* cleaner);
+mmwc_status mmwc_get_column_stats(const mmwc_cleaner* cleaner, size_t column, mmwc_column_stats* out);
+
+// One-shot cleaning of a complete in-memory CSV; MMWC_ERR_ARGUMENT on invalid config. When cfg->majority_gesture is
+// NULL it is computed with an extra pass over the buffer, like the executable.
+mmwc_status mmwc_clean_buffer(const mmwc_config* cfg, const char* data, size_t size, mmwc_stats* statsOut);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MMWAVE_CLEANER_H
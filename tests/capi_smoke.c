@@ -0,0 +1,290 @@
+// Smoke test for the C API: chunked feeding, dedup and reorder.
+// Run from the repository root (`make test`); reads data/down-to-up.csv.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mmwave_cleaner.h"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, \
+                    #cond);                                                  \
+            ++failures;                                                      \
+        }                                                                    \
+    } while (0)
+
+// Growable byte buffer the callbacks write rows into
+typedef struct buffer {
+    char* data;
+    size_t size;
+    size_t cap;
+} buffer;
+
+static void buffer_append(buffer* b, const char* s, size_t n) {
+    if (b->size + n + 1 > b->cap) {
+        size_t cap = b->cap ? b->cap : 4096;
+        while (cap < b->size + n + 1) {
+            cap *= 2;
+        }
+        b->data = (char*)realloc(b->data, cap);
+        if (!b->data) {
+            abort();
+        }
+        b->cap = cap;
+    }
+    memcpy(b->data + b->size, s, n);
+    b->size += n;
+    b->data[b->size] = '\0';
+}
+
+static void append_row(buffer* b, const mmwc_cell* cells, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (i) {
+            buffer_append(b, ",", 1);
+        }
+        buffer_append(b, cells[i].data, cells[i].size);
+    }
+    buffer_append(b, "\n", 1);
+}
+
+static void on_clean(void* user, const mmwc_cell* cells, size_t count) {
+    append_row((buffer*)user, cells, count);
+}
+
+static char* read_file(const char* path, size_t* sizeOut) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* data = (char*)malloc((size_t)n + 1);
+    if (data && fread(data, 1, (size_t)n, f) != (size_t)n) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *sizeOut = (size_t)n;
+    return data;
+}
+
+// Feeds data in chunks of `chunk` bytes (0 = whole buffer at once); clean rows go to out
+static mmwc_status run_chunked(mmwc_config cfg, const char* data, size_t size, size_t chunk,
+                               buffer* out, mmwc_stats* stats) {
+    cfg.on_clean = on_clean;
+    cfg.user = out;
+    mmwc_cleaner* c = mmwc_create(&cfg);
+    if (!c) {
+        return MMWC_ERR_INTERNAL;
+    }
+    mmwc_status st = MMWC_OK;
+    if (chunk == 0) {
+        chunk = size;
+    }
+    for (size_t off = 0; off < size && st == MMWC_OK; off += chunk) {
+        const size_t n = (size - off < chunk) ? size - off : chunk;
+        st = mmwc_feed(c, data + off, n);
+    }
+    if (st == MMWC_OK) {
+        st = mmwc_finish(c);
+    }
+    if (st == MMWC_OK) {
+        st = mmwc_get_stats(c, stats);
+    }
+    mmwc_destroy(c);
+    return st;
+}
+
+static void test_chunk_sizes(void) {
+    size_t size = 0;
+    char* data = read_file("data/down-to-up.csv", &size);
+    CHECK(data != NULL);
+    if (!data) {
+        return;
+    }
+
+    mmwc_config cfg;
+    mmwc_config_init(&cfg);
+    cfg.majority_gesture = "3";
+
+    buffer whole = {0};
+    mmwc_stats wholeStats;
+    CHECK(run_chunked(cfg, data, size, 0, &whole, &wholeStats) == MMWC_OK);
+    CHECK(wholeStats.rows_kept > 0);
+    CHECK(wholeStats.rows_kept + wholeStats.rows_dropped == wholeStats.rows_total);
+
+    const size_t chunks[] = {1, 7};
+    for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); ++i) {
+        buffer out = {0};
+        mmwc_stats stats;
+        CHECK(run_chunked(cfg, data, size, chunks[i], &out, &stats) == MMWC_OK);
+        CHECK(out.size == whole.size && memcmp(out.data, whole.data, whole.size) == 0);
+        CHECK(stats.rows_total == wholeStats.rows_total);
+        CHECK(stats.rows_kept == wholeStats.rows_kept);
+        free(out.data);
+    }
+
+    free(whole.data);
+    free(data);
+}
+
+static void test_resent_frame_dropped(void) {
+    static const char csv[] =
+        "timestamp,frameNum,gesturePresence,gesture\n"
+        "10.5,1,1,3\n"
+        "11.5,2,1,3\n"
+        "11.5,2,1,3\n"  // re-sent
+        "12.5,3,1,3\n"
+        "99.5,2,1,3\n";  // same frameNum, new capture session
+
+    mmwc_config cfg;
+    mmwc_config_init(&cfg);
+    cfg.majority_gesture = "3";
+
+    buffer out = {0};
+    mmwc_stats stats;
+    CHECK(run_chunked(cfg, csv, sizeof(csv) - 1, 0, &out, &stats) == MMWC_OK);
+    CHECK(stats.rows_total == 5);
+    CHECK(stats.rows_kept == 4);
+    CHECK(stats.duplicate_frames == 1);
+    CHECK(out.data && strcmp(out.data, "10.5,1,3\n11.5,2,3\n12.5,3,3\n99.5,2,3\n") == 0);
+    free(out.data);
+}
+
+static void test_long_timestamp_never_duplicate(void) {
+    static const char csv[] =
+        "timestamp,frameNum,gesturePresence,gesture\n"
+        "1234567890.12345678901234567890123,1,1,3\n"
+        "1234567890.12345678901234567890123,1,1,3\n";
+
+    mmwc_config cfg;
+    mmwc_config_init(&cfg);
+    cfg.majority_gesture = "3";
+
+    buffer out = {0};
+    mmwc_stats stats;
+    CHECK(run_chunked(cfg, csv, sizeof(csv) - 1, 0, &out, &stats) == MMWC_OK);
+    CHECK(stats.rows_kept == 2);
+    CHECK(stats.duplicate_frames == 0);
+    free(out.data);
+}
+
+static void test_reorder_keeps_blocks(void) {
+    // Second block restarts at frame 1 before anything of the first was released
+    static const char csv[] =
+        "timestamp,frameNum,gesturePresence,gesture\n"
+        "a,100,1,3\n"
+        "c,102,1,3\n"
+        "b,101,1,3\n"
+        "d,103,1,3\n"
+        "e,1,1,3\n"
+        "f,3,1,3\n"
+        "g,2,1,3\n";
+
+    mmwc_config cfg;
+    mmwc_config_init(&cfg);
+    cfg.majority_gesture = "3";
+    cfg.reorder_window_rows = 1000;
+
+    buffer out = {0};
+    mmwc_stats stats;
+    CHECK(run_chunked(cfg, csv, sizeof(csv) - 1, 0, &out, &stats) == MMWC_OK);
+    CHECK(stats.rows_kept == 7);
+    CHECK(stats.resequenced_rows == 2);
+    CHECK(out.data && strcmp(out.data,
+                             "a,100,3\nb,101,3\nc,102,3\nd,103,3\n"
+                             "e,1,3\ng,2,3\nf,3,3\n") == 0);
+    free(out.data);
+}
+
+static void test_reorder_passes_non_integer_frame(void) {
+    static const char csv[] =
+        "timestamp,frameNum,gesturePresence,gesture\n"
+        "a,2,1,3\n"
+        "b,1,1,3\n"
+        "c,7.0,1,3\n"
+        "d,3,1,3\n";
+
+    mmwc_config cfg;
+    mmwc_config_init(&cfg);
+    cfg.majority_gesture = "3";
+    cfg.reorder_window_rows = 16;
+
+    buffer out = {0};
+    mmwc_stats stats;
+    CHECK(run_chunked(cfg, csv, sizeof(csv) - 1, 0, &out, &stats) == MMWC_OK);
+    CHECK(stats.rows_kept == 4);
+    CHECK(out.data && strcmp(out.data, "b,1,3\na,2,3\nc,7.0,3\nd,3,3\n") == 0);
+    free(out.data);
+}
+
+// Number of places where the frameNum (second clean column) goes down
+static size_t count_frame_drops(const buffer* b) {
+    size_t drops = 0;
+    long long prev = 0;
+    int havePrev = 0;
+    const char* p = b->data;
+    const char* end = b->data + b->size;
+    while (p < end) {
+        const char* comma = memchr(p, ',', (size_t)(end - p));
+        const char* nl = memchr(p, '\n', (size_t)(end - p));
+        if (!comma || !nl || comma > nl) {
+            break;
+        }
+        const long long frame = strtoll(comma + 1, NULL, 10);
+        if (havePrev && frame < prev) {
+            ++drops;
+        }
+        prev = frame;
+        havePrev = 1;
+        p = nl + 1;
+    }
+    return drops;
+}
+
+static void test_reorder_keeps_blocks_in_sample(void) {
+    size_t size = 0;
+    char* data = read_file("data/down-to-up.csv", &size);
+    CHECK(data != NULL);
+    if (!data) {
+        return;
+    }
+
+    mmwc_config cfg;
+    mmwc_config_init(&cfg);
+    cfg.majority_gesture = "3";
+
+    // The sample holds three frameNum restarts (appended capture blocks)
+    const size_t windows[] = {1000, MMWC_MAX_REORDER_WINDOW_ROWS};
+    for (size_t i = 0; i < sizeof(windows) / sizeof(windows[0]); ++i) {
+        cfg.reorder_window_rows = windows[i];
+        buffer out = {0};
+        mmwc_stats stats;
+        CHECK(run_chunked(cfg, data, size, 4096, &out, &stats) == MMWC_OK);
+        CHECK(count_frame_drops(&out) == 3);
+        free(out.data);
+    }
+    free(data);
+}
+
+int main(void) {
+    test_chunk_sizes();
+    test_resent_frame_dropped();
+    test_long_timestamp_never_duplicate();
+    test_reorder_keeps_blocks();
+    test_reorder_passes_non_integer_frame();
+    test_reorder_keeps_blocks_in_sample();
+
+    if (failures) {
+        fprintf(stderr, "capi_smoke: %d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("capi_smoke: OK\n");
+    return 0;
+}